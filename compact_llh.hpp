@@ -0,0 +1,208 @@
+#ifndef COMPACT_LLH_HPP
+#define COMPACT_LLH_HPP
+
+#include "coordinate_converter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace coordinate_converter
+{
+  // 定点纬经高: 纬经度为纳度(1e-9度, 赤道处约0.11毫米), 高程为毫米
+  struct PackedLLH
+  {
+    int64_t lat = 0;
+    int64_t lon = 0;
+    int64_t h = 0;
+  };
+
+  namespace inner
+  {
+    static constexpr double kRad2NanoDeg = 180.0 / M_PI * 1e9;
+    static constexpr double kNanoDeg2Rad = M_PI / 180.0 * 1e-9;
+
+    inline uint64_t ZigZag(const int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    inline int64_t UnZigZag(const uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    inline void PutVarint(uint64_t v, std::vector<uint8_t> &out)
+    {
+      while (v >= 0x80)
+      {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+      }
+      out.push_back(static_cast<uint8_t>(v));
+    }
+
+    // 数据不完整时返回nullptr
+    inline uint8_t const *GetVarint(uint8_t const *p, uint8_t const *end, uint64_t &v)
+    {
+      v = 0;
+      for (int shift = 0; p < end && shift < 64; shift += 7)
+      {
+        uint8_t const byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+          return p;
+      }
+      return nullptr;
+    }
+  }
+
+  // pos为纬经度(弧度)与高程(米)
+  inline PackedLLH PackLLH(double const *pos)
+  {
+    PackedLLH p;
+    p.lat = std::llround(pos[0] * inner::kRad2NanoDeg);
+    p.lon = std::llround(pos[1] * inner::kRad2NanoDeg);
+    p.h = std::llround(pos[2] * 1e3);
+    return p;
+  }
+
+  inline void UnpackLLH(PackedLLH const &p, double *pos)
+  {
+    pos[0] = p.lat * inner::kNanoDeg2Rad;
+    pos[1] = p.lon * inner::kNanoDeg2Rad;
+    pos[2] = p.h * 1e-3;
+  }
+
+  /**
+   * @brief 纬经高序列的差分+zigzag+varint编码
+   *
+   * 每个点依次写入与前一点(首点与0)的纬度、经度、高程差值, 车载轨迹通常每点3~6字节.
+   */
+  class LLHEncoder
+  {
+  public:
+    void Reserve(const size_t n) { data_.reserve(n * 6); }
+
+    void Append(double const *pos) { Append(PackLLH(pos)); }
+    void Append(Eigen::Vector3d const &pos) { Append(pos.data()); }
+    void Append(PackedLLH const &p)
+    {
+      inner::PutVarint(inner::ZigZag(p.lat - prev_.lat), data_);
+      inner::PutVarint(inner::ZigZag(p.lon - prev_.lon), data_);
+      inner::PutVarint(inner::ZigZag(p.h - prev_.h), data_);
+      prev_ = p;
+      ++count_;
+    }
+
+    void Clear()
+    {
+      data_.clear();
+      prev_ = PackedLLH();
+      count_ = 0;
+    }
+
+    size_t Count() const { return count_; }
+    std::vector<uint8_t> const &Data() const { return data_; }
+
+  private:
+    std::vector<uint8_t> data_;
+    PackedLLH prev_;
+    size_t count_ = 0;
+  };
+
+  class LLHDecoder
+  {
+  public:
+    LLHDecoder(uint8_t const *data, const size_t len) : p_(data), end_(data + len) {}
+    explicit LLHDecoder(std::vector<uint8_t> const &data) : LLHDecoder(data.data(), data.size()) {}
+
+    bool Done() const { return error_ || p_ >= end_; }
+
+    // 数据被截断或损坏(varint不完整)
+    bool Error() const { return error_; }
+
+    bool Next(PackedLLH &p)
+    {
+      if (Done())
+        return false;
+      uint64_t d[3];
+      uint8_t const *q = p_;
+      for (int k = 0; k < 3 && q; ++k)
+        q = inner::GetVarint(q, end_, d[k]);
+      if (!q)
+      {
+        error_ = true;
+        return false;
+      }
+      p_ = q;
+      prev_.lat += inner::UnZigZag(d[0]);
+      prev_.lon += inner::UnZigZag(d[1]);
+      prev_.h += inner::UnZigZag(d[2]);
+      p = prev_;
+      return true;
+    }
+
+    // 最多解码n个点到pos(长度3n, 弧度/米), 返回实际解码个数
+    size_t Next(double *pos, const size_t n)
+    {
+      size_t i = 0;
+      PackedLLH p;
+      for (; i < n && Next(p); ++i)
+        UnpackLLH(p, pos + 3 * i);
+      return i;
+    }
+
+  private:
+    uint8_t const *p_;
+    uint8_t const *end_;
+    PackedLLH prev_;
+    bool error_ = false;
+  };
+
+  static constexpr size_t kLLHBlock = 256;
+
+  /**
+   * @brief 按块解码, 每块不超过kLLHBlock个点, 解码结果放在栈上缓冲区交给f(pos, n)
+   *
+   * @param max_points 最多解码的点数, 通常为调用方输出缓冲区的容量
+   * @param error 非空时输出数据是否截断、损坏或超出max_points, 此时返回值只是已解码的点数
+   * @return size_t 解码总点数
+   */
+  template <typename _Func>
+  size_t ForEachLLHBlock(uint8_t const *data, const size_t len, const size_t max_points, _Func &&f,
+                         bool *error = nullptr)
+  {
+    LLHDecoder dec(data, len);
+    double block[kLLHBlock * 3];
+    size_t total = 0;
+    for (size_t n = 0; total < max_points && (n = dec.Next(block, std::min(kLLHBlock, max_points - total))) > 0;
+         total += n)
+      f(static_cast<double const *>(block), n);
+    if (error)
+      *error = dec.Error() || !dec.Done();
+    return total;
+  }
+
+  // 解码并转换为ECEF, xyz长度为3 * max_points, 点数超出时停止并报告error
+  template <typename _Para>
+  size_t DecodeLLH2ECEF(uint8_t const *data, const size_t len, double *xyz, const size_t max_points,
+                        bool *error = nullptr)
+  {
+    return ForEachLLHBlock(
+        data, len, max_points, [&xyz](double const *pos, const size_t n)
+        {
+          Ellipsoid<_Para>::LLH2ECEF(pos, xyz, n);
+          xyz += 3 * n; },
+        error);
+  }
+
+  // 解码并转换为origin下的东北天坐标, enu长度为3 * max_points
+  template <typename _Para>
+  size_t DecodeLLH2ENU(Ellipsoid<_Para> const &ellipsoid, uint8_t const *data, const size_t len, double *enu,
+                       const size_t max_points, bool *error = nullptr)
+  {
+    return ForEachLLHBlock(
+        data, len, max_points, [&ellipsoid, &enu](double const *pos, const size_t n)
+        {
+          ellipsoid.LLH2ENU(pos, enu, n);
+          enu += 3 * n; },
+        error);
+  }
+
+} // namespace coordinate_converter
+
+#endif // COMPACT_LLH_HPP
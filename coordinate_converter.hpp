@@ -22,6 +22,21 @@ namespace coordinate_converter
   {
     static constexpr double Re = 6378137.0;
     static constexpr double F = (1.0 / 298.257223563);
+    static constexpr double We = 7.2921151467e-5; // 地球自转角速度 rad/s
+    static constexpr double GM = 3.986004418e14;  // 地心引力常数 m^3/s^2
+    static constexpr double Ge = 9.7803253359;    // 赤道正常重力 m/s^2
+    static constexpr double Gp = 9.8321849378;    // 极点正常重力 m/s^2
+  };
+
+  // 同一纬度下的地球参数, 由一次sin/cos计算得到, 供惯导机械编排使用
+  struct EarthState
+  {
+    double sinB = 0;
+    double cosB = 1;
+    double M = 0;              // 子午曲率半径
+    double N = 0;              // 卯酉曲率半径
+    double g = 0;              // 正常重力(含高程改正)
+    double wie[3] = {0, 0, 0}; // 地球自转角速度在东北天系下的投影
   };
 }
 
@@ -118,6 +133,26 @@ namespace coordinate_converter
       return pos;
     }
 
+    // 批量版本, pos/xyz 为长度3n的连续数组
+    static void LLH2ECEF(double const *pos, double *xyz, const size_t n)
+    {
+      for (size_t i = 0; i < n; ++i)
+        LLH2ECEF(pos + 3 * i, xyz + 3 * i);
+    }
+
+    // 批量版本, 需先设置origin
+    void LLH2ENU(double const *pos, double *enu, const size_t n) const
+    {
+      assert(!Ten_.translation().isZero(1e-12));
+      Eigen::Isometry3d const Tne = Ten_.inverse();
+      for (size_t i = 0; i < n; ++i)
+      {
+        Eigen::Vector3d xyz;
+        LLH2ECEF(pos + 3 * i, xyz.data());
+        Eigen::Map<Eigen::Vector3d>(enu + 3 * i) = Tne * xyz;
+      }
+    }
+
     // pos与origin均为纬经度，计算pos在origin坐标系下的东北天坐标
     static Eigen::Vector3d LLH2ENU(const Eigen::Vector3d &pos, const Eigen::Vector3d &origin)
     {
@@ -147,10 +182,82 @@ namespace coordinate_converter
     Eigen::Isometry3d Ten_ = Eigen::Isometry3d::Identity();
 
   public:
-    static constexpr double W(const double B_) { return sqrt(1 - pow(_e1 * sin(B_), 2)); }
-    static constexpr double V(const double B_) { return sqrt(1 + pow(_e2 * cos(B_), 2)); }
-    static constexpr double M(const double B_) { return _c / pow(V(B_), 3); } // 子午曲率半径
-    static constexpr double N(const double B_) { return _c / V(B_); }         // 卯酉曲率半径
+    static constexpr double W(const double B_)
+    {
+      double const s = sin(B_);
+      return sqrt(1 - _e1 * _e1 * s * s);
+    }
+    static constexpr double V(const double B_)
+    {
+      double const c = cos(B_);
+      return sqrt(1 + _e2 * _e2 * c * c);
+    }
+    static constexpr double M(const double B_) // 子午曲率半径
+    {
+      double const v = V(B_);
+      return _c / (v * v * v);
+    }
+    static constexpr double N(const double B_) { return _c / V(B_); } // 卯酉曲率半径
+
+    /**
+     * @brief 一次sin/cos计算得到曲率半径、Somigliana正常重力与地球自转角速度
+     *
+     * @param B_ 纬度(弧度)
+     * @param h_ 椭球高(米)
+     * @return EarthState
+     */
+    static EarthState Earth(const double B_, const double h_ = 0)
+    {
+      EarthState es;
+      Earth(B_, h_, es);
+      return es;
+    }
+
+    static void Earth(const double B_, const double h_, EarthState &es)
+    {
+      constexpr double e1_2 = _e1 * _e1;
+      constexpr double k = (_b * _Para::Gp) / (_a * _Para::Ge) - 1;
+      constexpr double m = _Para::We * _Para::We * _a * _a * _b / _Para::GM;
+
+      double const sb = sin(B_);
+      double const cb = cos(B_);
+      double const sb2 = sb * sb;
+      double const w2 = 1 - e1_2 * sb2;
+      double const w = sqrt(w2);
+
+      es.sinB = sb;
+      es.cosB = cb;
+      es.N = _a / w;
+      es.M = _a * (1 - e1_2) / (w2 * w);
+      double const g0 = _Para::Ge * (1 + k * sb2) / w;
+      es.g = g0 * (1 - 2 / _a * (1 + _f + m - 2 * _f * sb2) * h_ + 3 / (_a * _a) * h_ * h_);
+      es.wie[0] = 0;
+      es.wie[1] = _Para::We * cb;
+      es.wie[2] = _Para::We * sb;
+    }
+
+    // 批量版本, B_/h_/es 均为长度为n的数组, h_可为空(视为0)
+    static void Earth(double const *B_, double const *h_, EarthState *es, const size_t n)
+    {
+      for (size_t i = 0; i < n; ++i)
+        Earth(B_[i], h_ ? h_[i] : 0.0, es[i]);
+    }
+
+    // 位移角速度(东北天), vel为东北天速度
+    static void TransportRate(EarthState const &es, const double h_, double const *vel, double *wen)
+    {
+      double const rn = es.N + h_;
+      wen[0] = -vel[1] / (es.M + h_);
+      wen[1] = vel[0] / rn;
+      wen[2] = vel[0] * es.sinB / (es.cosB * rn);
+    }
+
+    static Eigen::Vector3d TransportRate(EarthState const &es, const double h_, Eigen::Vector3d const &vel)
+    {
+      Eigen::Vector3d wen = Eigen::Vector3d::Zero();
+      TransportRate(es, h_, vel.data(), wen.data());
+      return wen;
+    }
   };
 
   using WGS84 = Ellipsoid<WGS84Para>;
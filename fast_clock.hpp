@@ -0,0 +1,192 @@
+#pragma once
+#include "time_system.hpp"
+#include <cstdint>
+#include <ctime>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define TIME_SYSTEM_HAS_TSC 1
+#endif
+
+namespace time_system
+{
+  /**
+   * @brief 低开销时钟源, 用于采集循环中逐样本打时间戳
+   *
+   * 优先使用不变TSC计数器, 否则退回CLOCK_MONOTONIC_RAW. 计数器到纳秒的换算为定点乘法+移位,
+   * 每隔resync_ns与system_clock对齐一次, 对齐时以首次标定点为基线修正计数频率.
+   * 外推值超前于system_clock时不回跳, 而是在下一个对齐周期内放慢走速追平, 保证NowNs单调不减.
+   * 对象内部有状态且非线程安全, 多线程请使用ThreadClock().
+   */
+  class FastClock
+  {
+  public:
+    explicit FastClock(const int64_t resync_ns = 1000000000, const int64_t calib_ns = 5000000)
+        : resync_ns_(resync_ns)
+    {
+#ifdef TIME_SYSTEM_HAS_TSC
+      unsigned int a = 0, b = 0, c = 0, d = 0;
+      use_tsc_ = __get_cpuid(0x80000007, &a, &b, &c, &d) && (d & (1u << 8));
+#endif
+      Calibrate(calib_ns);
+    }
+
+    // 当前unix时间, 纳秒
+    int64_t NowNs()
+    {
+      uint64_t const tick = Ticks();
+      uint64_t const dt = tick - tick_base_;
+      if (dt > resync_ticks_)
+      {
+        Resync();
+        return ns_base_;
+      }
+      return ns_base_ + Scale(dt, slew_mult_);
+    }
+
+    // 当前unix时间, 精度_Dura
+    template <typename _Dura = sc::microseconds>
+    typename _Dura::rep Now()
+    {
+      return sc::duration_cast<_Dura>(_ns(NowNs())).count();
+    }
+
+    template <typename _Dura = sc::microseconds>
+    gpst_t NowGPST()
+    {
+      return Unix2GPST<_Dura>(Now<_Dura>());
+    }
+
+    bool UseTSC() const { return use_tsc_; }
+
+    // 计数器频率(每纳秒计数)
+    double TicksPerNs() const { return static_cast<double>(1ull << kShift) / mult_; }
+
+    /**
+     * @brief 重新标定计数器频率并与system_clock对齐, 会自旋calib_ns; 直接对齐, 不保证与此前读数单调
+     */
+    void Calibrate(const int64_t calib_ns = 5000000)
+    {
+      if (!use_tsc_)
+      {
+        mult_ = 1ull << kShift;
+      }
+      else
+      {
+        Sample(tick_ref_, mono_ref_, kMonoClock);
+        uint64_t tick = tick_ref_;
+        int64_t mono = mono_ref_;
+        while (mono - mono_ref_ < calib_ns)
+          Sample(tick, mono, kMonoClock);
+        SetRate(tick - tick_ref_, mono - mono_ref_);
+      }
+      Align();
+    }
+
+  private:
+    static constexpr int kShift = 32;
+#ifdef CLOCK_MONOTONIC_RAW
+    static constexpr clockid_t kMonoClock = CLOCK_MONOTONIC_RAW;
+#else
+    static constexpr clockid_t kMonoClock = CLOCK_MONOTONIC;
+#endif
+
+    static int64_t ReadClock(const clockid_t id)
+    {
+      timespec ts;
+      clock_gettime(id, &ts);
+      return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    uint64_t Ticks() const
+    {
+#ifdef TIME_SYSTEM_HAS_TSC
+      if (use_tsc_)
+        return __rdtsc();
+#endif
+      return static_cast<uint64_t>(ReadClock(kMonoClock));
+    }
+
+    // 读取参考时钟, 计数取前后两次读数的中点
+    void Sample(uint64_t &tick, int64_t &ref_ns, const clockid_t id) const
+    {
+      uint64_t const t0 = Ticks();
+      ref_ns = ReadClock(id);
+      uint64_t const t1 = Ticks();
+      tick = t0 + (t1 - t0) / 2;
+    }
+
+    void SetRate(const uint64_t ticks, const int64_t ns)
+    {
+      if (ticks == 0 || ns <= 0)
+        return;
+      mult_ = static_cast<uint64_t>(static_cast<long double>(ns) * (1ull << kShift) / ticks);
+    }
+
+    static int64_t Scale(const uint64_t dt, const uint64_t mult)
+    {
+#ifdef __SIZEOF_INT128__
+      return static_cast<int64_t>((static_cast<unsigned __int128>(dt) * mult) >> kShift);
+#else
+      return static_cast<int64_t>(static_cast<long double>(dt) * mult / (1ull << kShift));
+#endif
+    }
+
+    // 与system_clock对齐, 并按当前频率设置下次对齐的计数阈值
+    void Align()
+    {
+      Sample(tick_base_, ns_base_, CLOCK_REALTIME);
+      slew_mult_ = mult_;
+      resync_ticks_ = static_cast<uint64_t>(static_cast<long double>(resync_ns_) * (1ull << kShift) / mult_);
+    }
+
+    void Resync()
+    {
+      if (use_tsc_)
+      {
+        uint64_t tick = 0;
+        int64_t mono = 0;
+        Sample(tick, mono, kMonoClock);
+        SetRate(tick - tick_ref_, mono - mono_ref_);
+      }
+      uint64_t tick = 0;
+      int64_t target = 0;
+      Sample(tick, target, CLOCK_REALTIME);
+      // 以旧的走速外推到本次对齐点, 此值不小于此前所有读数
+      int64_t const current = ns_base_ + Scale(tick - tick_base_, slew_mult_);
+      int64_t const err = target - current;
+      tick_base_ = tick;
+      resync_ticks_ = static_cast<uint64_t>(static_cast<long double>(resync_ns_) * (1ull << kShift) / mult_);
+      if (err >= 0)
+      {
+        ns_base_ = target;
+        slew_mult_ = mult_;
+        return;
+      }
+      // 超前时保持当前读数, 下个周期内按比例放慢, 最多减半, 未追平部分留到后续周期
+      ns_base_ = current;
+      long double const ratio = std::max(0.5L, static_cast<long double>(resync_ns_ + err) / resync_ns_);
+      slew_mult_ = static_cast<uint64_t>(mult_ * ratio);
+    }
+
+  private:
+    bool use_tsc_ = false;
+    int64_t resync_ns_ = 1000000000;
+    uint64_t mult_ = 1ull << kShift; // 纳秒/计数, 左移kShift位的定点数
+    uint64_t slew_mult_ = mult_;     // 当前周期实际使用的走速, 超前时小于mult_
+    uint64_t tick_ref_ = 0;          // 首次标定点, 用于长基线修正频率
+    int64_t mono_ref_ = 0;
+    uint64_t tick_base_ = 0; // 最近一次对齐点
+    int64_t ns_base_ = 0;
+    uint64_t resync_ticks_ = 0;
+  };
+
+  // 每个线程一个时钟实例
+  inline FastClock &ThreadClock()
+  {
+    static thread_local FastClock clock;
+    return clock;
+  }
+
+  inline int64_t FastUnixTimeNs() { return ThreadClock().NowNs(); }
+}
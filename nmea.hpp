@@ -0,0 +1,347 @@
+#ifndef NMEA_HPP
+#define NMEA_HPP
+
+#include "coordinate_converter.hpp"
+#include "time_system.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace coordinate_converter
+{
+  // 语句中的一个字段, 指向原始缓冲区, 不拷贝
+  struct NmeaField
+  {
+    char const *p = nullptr;
+    size_t n = 0;
+    bool Empty() const { return n == 0; }
+  };
+
+  struct NmeaFix
+  {
+    enum Type
+    {
+      GGA,
+      RMC
+    };
+    Type type = GGA;
+    int64_t t = 0;      // unix时间, 精度由NmeaParser的模板参数决定
+    bool dated = false; // GGA不含日期, 取最近一条RMC的日期(跨零点时顺延), 尚无日期时为false且t无效
+    double llh[3] = {0, 0, 0}; // 纬经度(弧度)与椭球高(米), RMC无高程时为NaN
+    int quality = 0;           // GGA定位质量, RMC中A为1, V为0
+    int sats = 0;
+    double hdop = 0;
+    double speed = 0;  // RMC地速, 米/秒
+    double course = 0; // RMC航向, 弧度
+  };
+
+  namespace inner
+  {
+    inline int HexValue(const char c)
+    {
+      return c >= '0' && c <= '9' ? c - '0' : c >= 'A' && c <= 'F' ? c - 'A' + 10 : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+    }
+
+    // 解析形如[-]123.456的十进制数为整数尾数与小数位数, 格式错误时返回false
+    inline bool ParseDecimal(NmeaField const &f, int64_t &mant, int &frac)
+    {
+      if (f.Empty())
+        return false;
+      char const *p = f.p;
+      char const *const end = f.p + f.n;
+      bool const neg = *p == '-';
+      if (neg || *p == '+')
+        ++p;
+      mant = 0;
+      frac = 0;
+      int digits = 0;
+      for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digits)
+        mant = mant * 10 + (*p - '0');
+      if (p < end && *p == '.')
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digits, ++frac)
+          mant = mant * 10 + (*p - '0');
+      if (p != end || digits == 0 || digits > 18)
+        return false;
+      if (neg)
+        mant = -mant;
+      return true;
+    }
+
+    static constexpr int64_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+                                         10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+                                         1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000};
+
+    inline bool ParseNumber(NmeaField const &f, double &v)
+    {
+      int64_t mant = 0;
+      int frac = 0;
+      if (!ParseDecimal(f, mant, frac))
+        return false;
+      v = static_cast<double>(mant) / static_cast<double>(kPow10[frac]);
+      return true;
+    }
+
+    inline bool ParseInt(NmeaField const &f, int &v)
+    {
+      double d = 0;
+      if (!ParseNumber(f, d))
+        return false;
+      v = static_cast<int>(d);
+      return true;
+    }
+
+    // ddmm.mmmm/dddmm.mmmm + 半球, 输出弧度
+    inline bool ParseAngle(NmeaField const &value, NmeaField const &hemi, double &rad)
+    {
+      double v = 0;
+      if (!ParseNumber(value, v) || hemi.n != 1)
+        return false;
+      double const deg = std::floor(v / 100);
+      rad = (deg + (v - deg * 100) / 60) * (M_PI / 180);
+      if (*hemi.p == 'S' || *hemi.p == 'W')
+        rad = -rad;
+      return true;
+    }
+  }
+
+  /**
+   * @brief NMEA GGA/RMC流式解析器, 直接在输入缓冲区上切分字段, 不做堆分配
+   *
+   * 跨越Feed调用边界的半条语句暂存于内部定长缓冲区, 超长语句直接丢弃.
+   *
+   * @tparam _Dura 输出unix时间的精度
+   */
+  template <typename _Dura = time_system::sc::microseconds>
+  class NmeaParser
+  {
+  public:
+    static constexpr size_t kMaxSentence = 128;
+    static constexpr size_t kMaxFields = 24;
+    static constexpr int64_t kHalfDay = 43200;
+
+    /**
+     * @brief 输入任意长度的字节流, 每解析出一个定位结果调用一次on_fix(NmeaFix const &)
+     *
+     * @return size_t 本次输出的定位结果个数
+     */
+    template <typename _Func>
+    size_t Feed(char const *data, const size_t len, _Func &&on_fix)
+    {
+      size_t count = 0;
+      char const *p = data;
+      char const *const end = data + len;
+      if (carry_n_ > 0 || overflow_)
+      {
+        char const *nl = static_cast<char const *>(memchr(p, '\n', end - p));
+        size_t const take = (nl ? nl : end) - p;
+        if (!overflow_ && carry_n_ + take <= kMaxSentence)
+        {
+          memcpy(carry_ + carry_n_, p, take);
+          carry_n_ += take;
+        }
+        else
+          overflow_ = true;
+        if (!nl)
+          return 0;
+        if (!overflow_)
+          count += Line(carry_, carry_ + carry_n_, on_fix);
+        carry_n_ = 0;
+        overflow_ = false;
+        p = nl + 1;
+      }
+      while (p < end)
+      {
+        char const *nl = static_cast<char const *>(memchr(p, '\n', end - p));
+        if (!nl)
+        {
+          char const *start = static_cast<char const *>(memchr(p, '$', end - p));
+          if (start && static_cast<size_t>(end - start) <= kMaxSentence)
+          {
+            carry_n_ = end - start;
+            memcpy(carry_, start, carry_n_);
+          }
+          else if (start)
+            overflow_ = true;
+          break;
+        }
+        count += Line(p, nl, on_fix);
+        p = nl + 1;
+      }
+      return count;
+    }
+
+    /**
+     * @brief 输入结束时调用, 解析缓冲区中没有换行结尾的最后一条语句
+     *
+     * @return size_t 输出的定位结果个数(0或1)
+     */
+    template <typename _Func>
+    size_t Flush(_Func &&on_fix)
+    {
+      size_t count = 0;
+      if (!overflow_ && carry_n_ > 0)
+        count = Line(carry_, carry_ + carry_n_, on_fix);
+      carry_n_ = 0;
+      overflow_ = false;
+      return count;
+    }
+
+    /**
+     * @brief 解析单条语句, [begin, end)不含行尾, 可带前导噪声
+     *
+     * @return true 为校验通过的GGA/RMC语句
+     */
+    bool Parse(char const *begin, char const *end, NmeaFix &fix)
+    {
+      while (end > begin && (end[-1] == '\r' || end[-1] == '\n' || end[-1] == ' '))
+        --end;
+      char const *start = static_cast<char const *>(memchr(begin, '$', end - begin));
+      if (!start)
+        return false;
+      if (!Checksum(start, end))
+      {
+        ++checksum_errors_;
+        return false;
+      }
+
+      NmeaField f[kMaxFields];
+      size_t nf = 0;
+      char const *star = end - 3;
+      for (char const *p = start + 1; nf < kMaxFields;)
+      {
+        char const *comma = static_cast<char const *>(memchr(p, ',', star - p));
+        char const *fe = comma ? comma : star;
+        f[nf].p = p;
+        f[nf].n = fe - p;
+        ++nf;
+        if (!comma)
+          break;
+        p = comma + 1;
+      }
+      if (f[0].n != 5)
+        return false;
+      if (memcmp(f[0].p + 2, "GGA", 3) == 0)
+        return ParseGGA(f, nf, fix);
+      if (memcmp(f[0].p + 2, "RMC", 3) == 0)
+        return ParseRMC(f, nf, fix);
+      return false;
+    }
+
+    size_t ChecksumErrors() const { return checksum_errors_; }
+
+  private:
+    template <typename _Func>
+    size_t Line(char const *begin, char const *end, _Func &&on_fix)
+    {
+      NmeaFix fix;
+      if (!Parse(begin, end, fix))
+        return 0;
+      on_fix(static_cast<NmeaFix const &>(fix));
+      return 1;
+    }
+
+    // 要求以*hh结尾
+    static bool Checksum(char const *start, char const *end)
+    {
+      if (end - start < 4 || end[-3] != '*')
+        return false;
+      int const hi = inner::HexValue(end[-2]);
+      int const lo = inner::HexValue(end[-1]);
+      if (hi < 0 || lo < 0)
+        return false;
+      uint8_t sum = 0;
+      for (char const *p = start + 1; p < end - 3; ++p)
+        sum ^= static_cast<uint8_t>(*p);
+      return sum == ((hi << 4) | lo);
+    }
+
+    // hhmmss.ss, 整数秒交给Epoch2Unix, 小数部分以整数四舍五入到_Dura, 避免浮点截断少一个计数.
+    // GGA沿用最近一条RMC的日期, 时刻相对上一条回绕超过半天时视为跨日, 日期顺延一天, 直到下一条RMC重新对齐
+    bool SetTime(NmeaField const &hms, NmeaFix &fix)
+    {
+      int64_t mant = 0;
+      int frac = 0;
+      if (!inner::ParseDecimal(hms, mant, frac) || mant < 0)
+        return false;
+      for (; frac > 9; --frac)
+        mant /= 10;
+      int64_t const scale = inner::kPow10[frac];
+      int64_t const den = _Dura::period::den;
+      int64_t const sub = ((mant % scale) * den * 2 + scale) / (scale * 2);
+      int64_t const hhmmss = mant / scale;
+      int64_t const sod = hhmmss / 10000 * 3600 + hhmmss / 100 % 100 * 60 + hhmmss % 100;
+      if (last_sod_ >= 0 && sod + kHalfDay < last_sod_)
+        ++day_shift_;
+      else if (last_sod_ >= 0 && sod > last_sod_ + kHalfDay)
+        --day_shift_;
+      last_sod_ = sod;
+      fix.dated = ddmmyy_ > 0;
+      int64_t const day = time_system::sc::duration_cast<_Dura>(time_system::_day(1)).count();
+      fix.t = fix.dated ? time_system::Epoch2Unix<_Dura>(ddmmyy_, static_cast<double>(hhmmss)) + day_shift_ * day + sub : 0;
+      return true;
+    }
+
+    // $xxGGA,hhmmss.ss,lat,N,lon,E,quality,sats,hdop,alt,M,sep,M,...
+    bool ParseGGA(NmeaField const *f, const size_t nf, NmeaFix &fix)
+    {
+      if (nf < 12)
+        return false;
+      fix.type = NmeaFix::GGA;
+      double alt = 0, sep = 0;
+      if (!inner::ParseInt(f[6], fix.quality) || fix.quality == 0)
+        return false;
+      if (!SetTime(f[1], fix) ||
+          !inner::ParseAngle(f[2], f[3], fix.llh[0]) ||
+          !inner::ParseAngle(f[4], f[5], fix.llh[1]) ||
+          !inner::ParseNumber(f[9], alt))
+        return false;
+      inner::ParseInt(f[7], fix.sats);
+      inner::ParseNumber(f[8], fix.hdop);
+      inner::ParseNumber(f[11], sep);
+      fix.llh[2] = alt + sep;
+      return true;
+    }
+
+    // $xxRMC,hhmmss.ss,A,lat,N,lon,E,speed(kn),course(deg),ddmmyy,...
+    bool ParseRMC(NmeaField const *f, const size_t nf, NmeaFix &fix)
+    {
+      if (nf < 10)
+        return false;
+      int ddmmyy = 0;
+      if (f[9].n != 6 || !inner::ParseInt(f[9], ddmmyy))
+        return false;
+      // RMC的日期为准, 清除GGA推算的跨日
+      ddmmyy_ = ddmmyy;
+      day_shift_ = 0;
+      last_sod_ = -1;
+      fix.type = NmeaFix::RMC;
+      fix.quality = f[2].n == 1 && *f[2].p == 'A' ? 1 : 0;
+      if (fix.quality == 0)
+        return false;
+      if (!SetTime(f[1], fix) ||
+          !inner::ParseAngle(f[3], f[4], fix.llh[0]) ||
+          !inner::ParseAngle(f[5], f[6], fix.llh[1]))
+        return false;
+      fix.llh[2] = std::numeric_limits<double>::quiet_NaN();
+      double course = 0;
+      if (inner::ParseNumber(f[7], fix.speed))
+        fix.speed *= 1852.0 / 3600.0;
+      if (inner::ParseNumber(f[8], course))
+        fix.course = course * (M_PI / 180);
+      return true;
+    }
+
+  private:
+    char carry_[kMaxSentence];
+    size_t carry_n_ = 0;
+    bool overflow_ = false;
+    int32_t ddmmyy_ = 0;
+    int64_t day_shift_ = 0; // 相对ddmmyy_顺延的天数
+    int64_t last_sod_ = -1; // 上一条语句的日内秒, -1为未知
+    size_t checksum_errors_ = 0;
+  };
+
+} // namespace coordinate_converter
+
+#endif // NMEA_HPP
@@ -0,0 +1,113 @@
+#include "compact_llh.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace coordinate_converter;
+
+TEST(CompactLLH, pack)
+{
+  double const pos[3] = {30.123456789_deg, -120.987654321_deg, 12.3456};
+  double out[3];
+  UnpackLLH(PackLLH(pos), out);
+  // 纳度量化误差 < 0.1毫米, 高程量化 < 0.5毫米
+  EXPECT_NEAR(out[0], pos[0], 1e-11);
+  EXPECT_NEAR(out[1], pos[1], 1e-11);
+  EXPECT_NEAR(out[2], pos[2], 5e-4);
+
+  EXPECT_EQ(PackLLH(pos).lat, 30123456789);
+  EXPECT_EQ(PackLLH(pos).h, 12346);
+}
+
+TEST(CompactLLH, codec)
+{
+  std::vector<Eigen::Vector3d> llh;
+  for (int i = 0; i < 1000; ++i)
+    llh.emplace_back(30.0_deg + i * 1e-7, 120.0_deg - i * 2e-7, 10.0 + 0.01 * i);
+
+  LLHEncoder enc;
+  for (auto const &p : llh)
+    enc.Append(p);
+  EXPECT_EQ(enc.Count(), llh.size());
+  // 相邻点差值很小, 每点远小于24字节
+  EXPECT_LT(enc.Data().size(), llh.size() * 8);
+
+  LLHDecoder dec(enc.Data());
+  std::vector<double> pos(llh.size() * 3);
+  EXPECT_EQ(dec.Next(pos.data(), llh.size() + 10), llh.size());
+  EXPECT_TRUE(dec.Done());
+  EXPECT_FALSE(dec.Error());
+  for (size_t i = 0; i < llh.size(); ++i)
+  {
+    EXPECT_NEAR(pos[3 * i], llh[i][0], 1e-11);
+    EXPECT_NEAR(pos[3 * i + 1], llh[i][1], 1e-11);
+    EXPECT_NEAR(pos[3 * i + 2], llh[i][2], 5e-4);
+  }
+
+  // 截断的数据不会越界读取, 且报告错误
+  LLHDecoder partial(enc.Data().data(), enc.Data().size() - 1);
+  EXPECT_EQ(partial.Next(pos.data(), llh.size()), llh.size() - 1);
+  EXPECT_TRUE(partial.Error());
+  EXPECT_TRUE(partial.Done());
+
+  // 末字节带续位标志视为损坏
+  std::vector<uint8_t> corrupt = enc.Data();
+  corrupt.back() |= 0x80;
+  LLHDecoder bad(corrupt);
+  EXPECT_EQ(bad.Next(pos.data(), llh.size()), llh.size() - 1);
+  EXPECT_TRUE(bad.Error());
+}
+
+TEST(CompactLLH, kernels)
+{
+  Eigen::Vector3d origin{30.0_deg, 120.0_deg, 0};
+  WGS84 wgs84(origin);
+
+  LLHEncoder enc;
+  std::vector<Eigen::Vector3d> llh;
+  for (int i = 0; i < 600; ++i)
+  {
+    llh.emplace_back(30.0_deg + i * 3e-7, 120.0_deg + i * 1e-7, 5.0 - 0.002 * i);
+    enc.Append(llh.back());
+  }
+
+  std::vector<double> xyz(llh.size() * 3), enu(llh.size() * 3);
+  bool error = true;
+  EXPECT_EQ(DecodeLLH2ECEF<WGS84Para>(enc.Data().data(), enc.Data().size(), xyz.data(), llh.size(), &error), llh.size());
+  EXPECT_FALSE(error);
+  error = true;
+  EXPECT_EQ(DecodeLLH2ENU(wgs84, enc.Data().data(), enc.Data().size(), enu.data(), llh.size(), &error), llh.size());
+  EXPECT_FALSE(error);
+
+  // 截断发生在第二块中, 块函数应报告错误而非当作较短的合法数据
+  std::vector<double> partial(llh.size() * 3);
+  EXPECT_EQ(DecodeLLH2ECEF<WGS84Para>(enc.Data().data(), enc.Data().size() - 2, partial.data(), llh.size(), &error), llh.size() - 1);
+  EXPECT_TRUE(error);
+  error = false;
+  EXPECT_EQ(DecodeLLH2ENU(wgs84, enc.Data().data(), enc.Data().size() - 2, partial.data(), llh.size(), &error), llh.size() - 1);
+  EXPECT_TRUE(error);
+
+  // 数据中的点多于输出缓冲区时, 在容量处停止并报告, 不越界写
+  size_t const cap = kLLHBlock + 10;
+  std::vector<double> small(cap * 3 + 3, -1.0);
+  error = false;
+  EXPECT_EQ(DecodeLLH2ECEF<WGS84Para>(enc.Data().data(), enc.Data().size(), small.data(), cap, &error), cap);
+  EXPECT_TRUE(error);
+  EXPECT_EQ(small[cap * 3], -1.0);
+  EXPECT_EQ(small[cap * 3 - 1], xyz[cap * 3 - 1]);
+  error = false;
+  EXPECT_EQ(DecodeLLH2ENU(wgs84, enc.Data().data(), enc.Data().size(), small.data(), cap, &error), cap);
+  EXPECT_TRUE(error);
+  EXPECT_EQ(small[cap * 3], -1.0);
+  // 容量恰好等于点数不算溢出
+  EXPECT_EQ(DecodeLLH2ECEF<WGS84Para>(enc.Data().data(), enc.Data().size(), partial.data(), llh.size(), &error), llh.size());
+  EXPECT_FALSE(error);
+
+  for (size_t i = 0; i < llh.size(); ++i)
+  {
+    Eigen::Vector3d const xyz_true = WGS84::LLH2ECEF(llh[i]);
+    Eigen::Vector3d const enu_true = wgs84.LLH2ENU(llh[i]);
+    // 毫米级保真
+    EXPECT_LT((Eigen::Map<Eigen::Vector3d>(xyz.data() + 3 * i) - xyz_true).norm(), 1e-3);
+    EXPECT_LT((Eigen::Map<Eigen::Vector3d>(enu.data() + 3 * i) - enu_true).norm(), 1e-3);
+  }
+}
@@ -49,4 +49,33 @@ TEST(Ellipsoid, origin)
   EXPECT_TRUE(enu_true.isApprox(enu, 1e-4));
   EXPECT_TRUE(llh_true.isApprox(llh, 1e-8));
   EXPECT_TRUE(ecef_true.isApprox(ecef, 1e-8));
-}
\ No newline at end of file
+}
+
+TEST(Ellipsoid, earth)
+{
+  // 赤道与极点处正常重力应分别等于Ge与Gp
+  EXPECT_NEAR(WGS84::Earth(0).g, WGS84Para::Ge, 1e-10);
+  EXPECT_NEAR(WGS84::Earth(90.0_deg).g, WGS84Para::Gp, 1e-10);
+  EXPECT_NEAR(WGS84::Earth(45.0_deg).g, 9.8061977693, 1e-9);
+  // 高程每升高1米重力约减小3.086e-6
+  EXPECT_NEAR(WGS84::Earth(45.0_deg, 0).g - WGS84::Earth(45.0_deg, 1).g, 3.086e-6, 1e-8);
+
+  double const b[] = {0.0, 30.0_deg, -45.0_deg, 60.0_deg};
+  double const h[] = {0.0, 100.0, 1000.0, -10.0};
+  EarthState es[4];
+  WGS84::Earth(b, h, es, 4);
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_NEAR(es[i].M, WGS84::M(b[i]), 1e-6);
+    EXPECT_NEAR(es[i].N, WGS84::N(b[i]), 1e-6);
+    EXPECT_NEAR(es[i].wie[1], WGS84Para::We * cos(b[i]), 1e-18);
+    EXPECT_NEAR(es[i].wie[2], WGS84Para::We * sin(b[i]), 1e-18);
+    EXPECT_DOUBLE_EQ(es[i].g, WGS84::Earth(b[i], h[i]).g);
+  }
+
+  Eigen::Vector3d vel{10, 20, 0};
+  Eigen::Vector3d wen = WGS84::TransportRate(es[1], h[1], vel);
+  EXPECT_NEAR(wen[0], -20 / (es[1].M + h[1]), 1e-15);
+  EXPECT_NEAR(wen[1], 10 / (es[1].N + h[1]), 1e-15);
+  EXPECT_NEAR(wen[2], 10 * tan(b[1]) / (es[1].N + h[1]), 1e-15);
+}
@@ -0,0 +1,76 @@
+#include "fast_clock.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace time_system;
+
+TEST(FastClock, NowNs)
+{
+  FastClock clock;
+  GTEST_LOG_(INFO) << "use tsc " << clock.UseTSC() << " ticks/ns " << clock.TicksPerNs();
+
+  int64_t const sys = sc::duration_cast<_ns>(sc::system_clock::now().time_since_epoch()).count();
+  int64_t const now = clock.NowNs();
+  // 与系统时间相差应在1ms以内
+  EXPECT_NEAR(static_cast<double>(now), static_cast<double>(sys), 1e6);
+
+  // 连续读数单调不减
+  int64_t last = clock.NowNs();
+  for (int i = 0; i < 100000; ++i)
+  {
+    int64_t const t = clock.NowNs();
+    EXPECT_GE(t, last);
+    last = t;
+  }
+}
+
+TEST(FastClock, Resync)
+{
+  // 10ms对齐一次, 跨越若干次对齐后仍与系统时间一致
+  FastClock clock(10000000);
+  for (int i = 0; i < 5; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(12));
+    int64_t const sys = sc::duration_cast<_ns>(sc::system_clock::now().time_since_epoch()).count();
+    EXPECT_NEAR(static_cast<double>(clock.NowNs()), static_cast<double>(sys), 1e6);
+  }
+}
+
+TEST(FastClock, MonotonicAcrossResync)
+{
+  // 对齐周期很短时每秒跨越上万次对齐, 读数不得回退
+  for (int64_t resync_ns : {1000000, 100000, 20000})
+  {
+    FastClock clock(resync_ns);
+    int64_t last = clock.NowNs();
+    int64_t const stop = last + 200000000;
+    size_t backward = 0;
+    while (last < stop)
+    {
+      int64_t const t = clock.NowNs();
+      if (t < last)
+        ++backward;
+      last = t;
+    }
+    EXPECT_EQ(backward, 0u) << resync_ns;
+
+    int64_t const sys = sc::duration_cast<_ns>(sc::system_clock::now().time_since_epoch()).count();
+    EXPECT_NEAR(static_cast<double>(clock.NowNs()), static_cast<double>(sys), 1e6) << resync_ns;
+  }
+}
+
+TEST(FastClock, Templates)
+{
+  FastClock &clock = ThreadClock();
+  int64_t const us = clock.Now();
+  int64_t const ms = clock.Now<std::chrono::milliseconds>();
+  EXPECT_NEAR(static_cast<double>(us / 1000), static_cast<double>(ms), 2.0);
+
+  gpst_t const gpst = clock.NowGPST();
+  gpst_t const gpst_sys = Unix2GPST(sc::duration_cast<_us>(sc::system_clock::now().time_since_epoch()).count());
+  EXPECT_EQ(gpst.first, gpst_sys.first);
+  EXPECT_NEAR(gpst.second, gpst_sys.second, 1e-2);
+
+  EXPECT_NEAR(FastUnixTimeNs() / 1e9, CurrentUnixTime(), 1e-2);
+}
@@ -0,0 +1,206 @@
+#include "nmea.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace coordinate_converter;
+
+namespace
+{
+  // 为body补上$与*hh校验和
+  std::string Sentence(std::string const &body)
+  {
+    unsigned sum = 0;
+    for (char c : body)
+      sum ^= static_cast<unsigned char>(c);
+    char tail[8];
+    snprintf(tail, sizeof(tail), "*%02X\r\n", sum);
+    return "$" + body + tail;
+  }
+
+  template <typename _Dura>
+  int64_t RmcTime(std::string const &hhmmss)
+  {
+    std::string const log = Sentence("GNRMC," + hhmmss + ",A,3016.1234,N,12008.5678,E,10.0,90.0,150321,,,A");
+    NmeaParser<_Dura> parser;
+    int64_t t = -1;
+    parser.Feed(log.data(), log.size(), [&t](NmeaFix const &fix)
+                { t = fix.t; });
+    return t;
+  }
+
+  std::string const kLog =
+      "$GPGGA,083558.00,3016.1234,N,12008.5678,E,1,08,1.0,10.5,M,7.2,M,,*5B\r\n"
+      "$GNRMC,083559.50,A,3016.1234,N,12008.5678,E,10.0,90.0,150321,,,A*4C\r\n"
+      "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"
+      "$GNGGA,083600.00,3016.1234,N,12008.5678,E,4,12,0.8,10.5,M,7.2,M,1.0,0000*58\r\n"
+      "$GNGGA,083600.00,3016.1234,N,12008.5678,E,4,12,0.8,10.5,M,7.2,M,1.0,0000*59\r\n"
+      "$GPGGA,083601.00,3016.1234,S,12008.5678,W,1,08,1.0,10.5,M,-2.0,M,,*4A\r\n";
+}
+
+TEST(Nmea, parse)
+{
+  NmeaParser<> parser;
+  std::vector<NmeaFix> fixes;
+  size_t n = parser.Feed(kLog.data(), kLog.size(), [&fixes](NmeaFix const &fix)
+                         { fixes.push_back(fix); });
+
+  // 首条GGA校验和错误, GSV忽略, 第二条GNGGA校验和错误
+  ASSERT_EQ(n, 3u);
+  ASSERT_EQ(fixes.size(), 3u);
+  EXPECT_EQ(parser.ChecksumErrors(), 2u);
+
+  double const lat = (30 + 16.1234 / 60) * M_PI / 180;
+  double const lon = (120 + 8.5678 / 60) * M_PI / 180;
+
+  NmeaFix const &rmc = fixes[0];
+  EXPECT_EQ(rmc.type, NmeaFix::RMC);
+  EXPECT_TRUE(rmc.dated);
+  EXPECT_EQ(rmc.t, time_system::Epoch2Unix(2021, 3, 15, 8, 35, 59.5));
+  EXPECT_NEAR(rmc.llh[0], lat, 1e-12);
+  EXPECT_NEAR(rmc.llh[1], lon, 1e-12);
+  EXPECT_TRUE(std::isnan(rmc.llh[2]));
+  EXPECT_NEAR(rmc.speed, 10.0 * 1852 / 3600, 1e-12);
+  EXPECT_NEAR(rmc.course, M_PI / 2, 1e-12);
+
+  NmeaFix const &gga = fixes[1];
+  EXPECT_EQ(gga.type, NmeaFix::GGA);
+  EXPECT_TRUE(gga.dated);
+  EXPECT_EQ(gga.t, time_system::Epoch2Unix(2021, 3, 15, 8, 36, 0.0));
+  EXPECT_EQ(gga.quality, 4);
+  EXPECT_EQ(gga.sats, 12);
+  EXPECT_NEAR(gga.hdop, 0.8, 1e-12);
+  EXPECT_NEAR(gga.llh[2], 17.7, 1e-9);
+
+  NmeaFix const &south = fixes[2];
+  EXPECT_NEAR(south.llh[0], -lat, 1e-12);
+  EXPECT_NEAR(south.llh[1], -lon, 1e-12);
+  EXPECT_NEAR(south.llh[2], 8.5, 1e-9);
+
+  // 输出可直接交给坐标转换
+  Eigen::Vector3d ecef = WGS84::LLH2ECEF(Eigen::Vector3d(gga.llh));
+  EXPECT_NEAR(WGS84::ECEF2LLH(ecef)[0], lat, 1e-9);
+}
+
+TEST(Nmea, stream)
+{
+  // 按任意长度分块输入, 结果应与整体输入一致
+  for (size_t chunk : {1, 3, 7, 50, 1000})
+  {
+    NmeaParser<std::chrono::milliseconds> parser;
+    std::vector<NmeaFix> fixes;
+    for (size_t i = 0; i < kLog.size(); i += chunk)
+      parser.Feed(kLog.data() + i, std::min(chunk, kLog.size() - i), [&fixes](NmeaFix const &fix)
+                  { fixes.push_back(fix); });
+    ASSERT_EQ(fixes.size(), 3u) << chunk;
+    EXPECT_EQ(fixes[1].t, time_system::Epoch2Unix<std::chrono::milliseconds>(2021, 3, 15, 8, 36, 0.0));
+  }
+}
+
+TEST(Nmea, malformed)
+{
+  NmeaParser<> parser;
+  NmeaFix fix;
+  std::string const no_checksum = "$GNGGA,083600.00,3016.1234,N,12008.5678,E,4,12,0.8,10.5,M,7.2,M,1.0,0000";
+  EXPECT_FALSE(parser.Parse(no_checksum.data(), no_checksum.data() + no_checksum.size(), fix));
+  std::string const noise = "garbage without sentence";
+  EXPECT_FALSE(parser.Parse(noise.data(), noise.data() + noise.size(), fix));
+
+  // 超长行被丢弃, 不影响后续语句
+  std::string const longline = "$" + std::string(500, 'x') + "\n" + kLog;
+  std::vector<NmeaFix> fixes;
+  for (size_t i = 0; i < longline.size(); i += 64)
+    parser.Feed(longline.data() + i, std::min<size_t>(64, longline.size() - i), [&fixes](NmeaFix const &f)
+                { fixes.push_back(f); });
+  EXPECT_EQ(fixes.size(), 3u);
+}
+
+TEST(Nmea, fraction)
+{
+  // 小数秒不经过double截断, 结果精确到计数
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+  using std::chrono::nanoseconds;
+  int64_t const base_s = time_system::Epoch2Unix<std::chrono::seconds>(2021, 3, 15, 8, 35, 59.0);
+  EXPECT_EQ(RmcTime<microseconds>("083559.12"), base_s * 1000000 + 120000);
+  EXPECT_EQ(RmcTime<microseconds>("083559.29"), base_s * 1000000 + 290000);
+  EXPECT_EQ(RmcTime<microseconds>("083559.99"), base_s * 1000000 + 990000);
+  EXPECT_EQ(RmcTime<milliseconds>("083559.12"), base_s * 1000 + 120);
+  EXPECT_EQ(RmcTime<milliseconds>("083559.29"), base_s * 1000 + 290);
+  EXPECT_EQ(RmcTime<milliseconds>("083559.99"), base_s * 1000 + 990);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    char hms[16];
+    snprintf(hms, sizeof(hms), "083559.%02d", i);
+    EXPECT_EQ(RmcTime<milliseconds>(hms), base_s * 1000 + i * 10) << hms;
+    EXPECT_EQ(RmcTime<microseconds>(hms), base_s * 1000000 + i * 10000) << hms;
+    EXPECT_EQ(RmcTime<nanoseconds>(hms), base_s * 1000000000 + i * 10000000LL) << hms;
+  }
+
+  // 比输出精度更细的小数四舍五入
+  EXPECT_EQ(RmcTime<milliseconds>("083559.1235"), base_s * 1000 + 124);
+  EXPECT_EQ(RmcTime<std::chrono::seconds>("083559.5"), base_s + 1);
+}
+
+TEST(Nmea, flush)
+{
+  // 最后一条语句没有换行, 需Flush才能输出
+  std::string const rmc = "$GNRMC,083559.50,A,3016.1234,N,12008.5678,E,10.0,90.0,150321,,,A*4C";
+  std::string const log = kLog + rmc;
+  for (size_t chunk : {1, 7, 1000})
+  {
+    NmeaParser<> parser;
+    std::vector<NmeaFix> fixes;
+    auto on_fix = [&fixes](NmeaFix const &fix)
+    { fixes.push_back(fix); };
+    for (size_t i = 0; i < log.size(); i += chunk)
+      parser.Feed(log.data() + i, std::min(chunk, log.size() - i), on_fix);
+    EXPECT_EQ(fixes.size(), 3u) << chunk;
+    EXPECT_EQ(parser.Flush(on_fix), 1u) << chunk;
+    ASSERT_EQ(fixes.size(), 4u) << chunk;
+    EXPECT_EQ(fixes.back().type, NmeaFix::RMC);
+    // 再次Flush不会重复输出
+    EXPECT_EQ(parser.Flush(on_fix), 0u);
+  }
+
+  // 半条语句不会产生结果
+  NmeaParser<> parser;
+  size_t n = 0;
+  parser.Feed(rmc.data(), rmc.size() - 10, [&n](NmeaFix const &)
+              { ++n; });
+  EXPECT_EQ(parser.Flush([&n](NmeaFix const &)
+                         { ++n; }),
+            0u);
+  EXPECT_EQ(n, 0u);
+}
+
+TEST(Nmea, midnight)
+{
+  // 跨零点时GGA先于RMC到达, GGA应顺延到次日而非回跳一天
+  std::string const log =
+      Sentence("GNRMC,235959.00,A,3016.1234,N,12008.5678,E,10.0,90.0,150321,,,A") +
+      Sentence("GNGGA,235959.50,3016.1234,N,12008.5678,E,1,08,1.0,10.5,M,7.2,M,,") +
+      Sentence("GNGGA,000000.00,3016.1234,N,12008.5678,E,1,08,1.0,10.5,M,7.2,M,,") +
+      Sentence("GNRMC,000000.00,A,3016.1234,N,12008.5678,E,10.0,90.0,160321,,,A") +
+      Sentence("GNGGA,000000.50,3016.1234,N,12008.5678,E,1,08,1.0,10.5,M,7.2,M,,");
+  NmeaParser<> parser;
+  std::vector<int64_t> t;
+  parser.Feed(log.data(), log.size(), [&t](NmeaFix const &fix)
+              { t.push_back(fix.t); });
+  int64_t const midnight = time_system::Epoch2Unix(2021, 3, 16);
+  ASSERT_EQ(t.size(), 5u);
+  EXPECT_EQ(t[0], midnight - 1000000);
+  EXPECT_EQ(t[1], midnight - 500000);
+  EXPECT_EQ(t[2], midnight);
+  EXPECT_EQ(t[3], midnight);
+  EXPECT_EQ(t[4], midnight + 500000);
+
+  // 乱序到达的前一日GGA不应被推到次日
+  std::string const late = Sentence("GNGGA,235959.90,3016.1234,N,12008.5678,E,1,08,1.0,10.5,M,7.2,M,,");
+  parser.Feed(late.data(), late.size(), [&t](NmeaFix const &fix)
+              { t.push_back(fix.t); });
+  ASSERT_EQ(t.size(), 6u);
+  EXPECT_EQ(t[5], midnight - 100000);
+}
@@ -0,0 +1,97 @@
+#include "time_scale.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace time_system;
+
+TEST(TimeScale, constant)
+{
+  // 同一基准的尺度对在编译期求值
+  static_assert(ScaleConverter<scale::GPST, scale::BDT>::kConstant, "");
+  static_assert(ConvertScale<scale::GPST, scale::BDT, sc::seconds>(100) == 86, "");
+  static_assert(ConvertScale<scale::GPST, scale::TAI, sc::seconds>(100) == 119, "");
+  static_assert(ConvertScale<scale::GST, scale::GPST, sc::seconds>(100) == 100, "");
+  static_assert(ConvertScale<scale::UTC, scale::GLONASST, sc::seconds>(0) == 3 * 3600, "");
+  static_assert(!ScaleConverter<scale::UTC, scale::GPST>::kConstant, "");
+
+  int64_t const t = 1609459200123456; // 2021-01-01 00:00:00.123456 BDT
+  EXPECT_EQ((ConvertScale<scale::TAI, scale::BDT>(ConvertScale<scale::BDT, scale::TAI>(t))), t);
+  EXPECT_EQ((ConvertScale<scale::BDT, scale::GPST>(t)) - t, 14000000);
+}
+
+TEST(TimeScale, leap)
+{
+  int64_t const utc = 1609459200000000; // 2021-01-01 00:00:00 UTC
+  EXPECT_EQ((ConvertScale<scale::UTC, scale::GPST>(utc)) - utc, 18000000);
+  EXPECT_EQ((ConvertScale<scale::UTC, scale::TAI>(utc)) - utc, 37000000);
+  EXPECT_EQ((ConvertScale<scale::UTC, scale::BDT>(utc)) - utc, 4000000);
+  EXPECT_EQ((ConvertScale<scale::GLONASST, scale::GPST>(utc + 10800000000LL)) - utc, 18000000);
+
+  // 闰秒表每一项: 表中时刻起即为新的闰秒数, 两个方向互逆
+  for (auto const &row : inner::__leaps)
+  {
+    int64_t const utc_at = row.first;
+    int32_t const leap = -row.second;    // GPST - UTC
+    int64_t const gps_at = utc_at + leap; // 新闰秒数生效时的GPST
+    EXPECT_EQ((ConvertScale<scale::UTC, scale::GPST, sc::seconds>(utc_at)), gps_at) << utc_at;
+    EXPECT_EQ((ConvertScale<scale::UTC, scale::GPST, sc::seconds>(utc_at - 1)), gps_at - 2) << utc_at;
+    EXPECT_EQ((ConvertScale<scale::GPST, scale::UTC, sc::seconds>(gps_at)), utc_at) << utc_at;
+    EXPECT_EQ((ConvertScale<scale::GPST, scale::UTC, sc::seconds>(gps_at + 1)), utc_at + 1) << utc_at;
+    EXPECT_EQ((ConvertScale<scale::GPST, scale::UTC, sc::seconds>(gps_at - 2)), utc_at - 1) << utc_at;
+    // 插入的闰秒(23:59:60)映射到其后的整秒
+    EXPECT_EQ((ConvertScale<scale::GPST, scale::UTC, sc::seconds>(gps_at - 1)), utc_at) << utc_at;
+
+    for (int64_t gps = gps_at - 3; gps <= gps_at + 3; ++gps)
+    {
+      if (gps != gps_at - 1)
+      {
+        EXPECT_EQ((ConvertScale<scale::UTC, scale::GPST, sc::seconds>(ConvertScale<scale::GPST, scale::UTC, sc::seconds>(gps))), gps) << gps;
+      }
+    }
+    for (int64_t utc_s = utc_at - 3; utc_s <= utc_at + 3; ++utc_s)
+    {
+      EXPECT_EQ((ConvertScale<scale::GPST, scale::UTC, sc::seconds>(ConvertScale<scale::UTC, scale::GPST, sc::seconds>(utc_s))), utc_s) << utc_s;
+      EXPECT_EQ((ConvertScale<scale::TAI, scale::UTC, sc::seconds>(ConvertScale<scale::UTC, scale::TAI, sc::seconds>(utc_s))), utc_s) << utc_s;
+    }
+  }
+
+  // 1980年之前闰秒表为空
+  EXPECT_EQ((ConvertScale<scale::UTC, scale::GPST, sc::seconds>(0)), 0);
+}
+
+TEST(TimeScale, batch)
+{
+  // 跨越多个闰秒, 批量结果与逐个转换一致
+  std::vector<int64_t> utc;
+  for (int64_t t = 1136073600000LL - 86400000LL * 365 * 6; t < 1483228800000LL + 86400000LL; t += 86400000LL * 7 + 1234)
+    utc.push_back(t);
+  // 包含每个闰秒时刻前后
+  for (auto const &row : inner::__leaps)
+    for (int64_t d = -2000; d <= 2000; d += 500)
+      utc.push_back(row.first * 1000 + d);
+
+  std::vector<int64_t> bdt(utc.size()), back(utc.size());
+  ConvertScale<scale::UTC, scale::BDT, sc::milliseconds>(utc.data(), bdt.data(), utc.size());
+  ConvertScale<scale::BDT, scale::UTC, sc::milliseconds>(bdt.data(), back.data(), bdt.size());
+  for (size_t i = 0; i < utc.size(); ++i)
+  {
+    EXPECT_EQ(bdt[i], (ConvertScale<scale::UTC, scale::BDT, sc::milliseconds>(utc[i])));
+    EXPECT_EQ(back[i], utc[i]);
+  }
+
+  std::vector<int64_t> gst(utc.size());
+  ConvertScale<scale::BDT, scale::GST, sc::milliseconds>(bdt.data(), gst.data(), bdt.size());
+  for (size_t i = 0; i < utc.size(); ++i)
+    EXPECT_EQ(gst[i] - bdt[i], 14000);
+}
+
+TEST(TimeScale, GPSTime)
+{
+  int64_t const utc = 1609459200000000;
+  EXPECT_EQ(Scale2GPSTime<scale::UTC>(utc), Unix2GPSTime(utc));
+  EXPECT_EQ(GPSTime2Scale<scale::UTC>(Unix2GPSTime(utc)), utc);
+
+  GPSTime<sc::nanoseconds> t(2138, 12345LL);
+  int64_t const bdt = GPSTime2Scale<scale::BDT>(t);
+  EXPECT_EQ((Scale2GPSTime<scale::BDT, sc::nanoseconds>(bdt)), t);
+}
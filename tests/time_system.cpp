@@ -224,4 +224,39 @@ TEST(TimeSystem, CurrentUnixTime)
 
   // 验证当前时间与系统时间接近（允许1秒的误差）
   EXPECT_NEAR(current_time, static_cast<double>(now_s), 1.0);
-}
\ No newline at end of file
+}
+
+TEST(TimeSystem, GPSTime)
+{
+  // 整数运算可在编译期完成
+  constexpr GPSTime<> t0(2000, 3600 * 1000000LL);
+  static_assert(t0.Week() == 2000, "");
+  static_assert((t0 + _us(7 * 24 * 3600 * 1000000LL)).Week() == 2001, "");
+  static_assert((t0 - _us(3601 * 1000000LL)).Week() == 1999, "");
+  static_assert(t0 < t0 + _us(1), "");
+  static_assert((t0 + _us(5)) - t0 == _us(5), "");
+
+  // 与double版本结果一致
+  EXPECT_EQ(GPST2Unix(t0), GPST2Unix(2000, 3600.0));
+  EXPECT_EQ(GPST2Unix(GPSTime<_ns>(2000, 3600 * 1000000000LL)), GPST2Unix<_ns>(2000, 3600.0));
+
+  unix_t const unix_time = 1609459200000000; // 2021-01-01 00:00:00 UTC
+  GPSTime<> gpst = Unix2GPSTime(unix_time);
+  gpst_t const gpst_pair = Unix2GPST(unix_time);
+  EXPECT_EQ(gpst.Week(), gpst_pair.first);
+  EXPECT_DOUBLE_EQ(gpst.Seconds(), gpst_pair.second);
+  EXPECT_EQ(gpst.ToUnix(), unix_time);
+  EXPECT_EQ(GPSTime<>::FromPair(gpst_pair), gpst);
+
+  // 纳秒精度下周末附近不丢失精度
+  GPSTime<_ns> t_ns(2138, 7 * 24 * 3600 * 1000000000LL - 1);
+  EXPECT_EQ(t_ns.Week(), 2138);
+  EXPECT_EQ((t_ns + _ns(2)).Week(), 2139);
+  EXPECT_EQ((t_ns + _ns(2)).Ticks(), 1);
+  EXPECT_EQ(Unix2GPSTime<_ns>(t_ns.ToUnix()), t_ns);
+
+  // 字符串格式与GPST2Str一致
+  EXPECT_EQ(GPST2Str(t0, true), GPST2Str(gpst_t(2000, 3600.0), true));
+  EXPECT_EQ(GPST2Str(GPSTime<_ms>(2000, 3600123LL)), GPST2Str<_ms>(gpst_t(2000, 3600.123)));
+  EXPECT_EQ(GPSTime<_ns>(2000, 1LL).ToStr(), "     0.000000001");
+}
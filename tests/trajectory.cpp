@@ -0,0 +1,125 @@
+#include "trajectory.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace coordinate_converter;
+
+TEST(Trajectory, linear)
+{
+  Trajectory<> traj;
+  EXPECT_TRUE(traj.Append(1000000, {0, 0, 0}));
+  EXPECT_TRUE(traj.Append(2000000, {10, 20, -2}));
+  EXPECT_TRUE(traj.Append(3000000, {20, 20, 0}));
+  // 时间必须严格递增
+  EXPECT_FALSE(traj.Append(3000000, {0, 0, 0}));
+  EXPECT_EQ(traj.Size(), 3u);
+
+  Eigen::Vector3d pos;
+  EXPECT_TRUE(traj.Position(1500000, pos));
+  EXPECT_TRUE(pos.isApprox(Eigen::Vector3d(5, 10, -1)));
+  EXPECT_TRUE(traj.Position(3000000, pos));
+  EXPECT_TRUE(pos.isApprox(Eigen::Vector3d(20, 20, 0)));
+  EXPECT_TRUE(traj.Position(2000000, pos));
+  EXPECT_TRUE(pos.isApprox(Eigen::Vector3d(10, 20, -2)));
+
+  EXPECT_FALSE(traj.Position(999999, pos));
+  EXPECT_FALSE(traj.Position(3000001, pos));
+}
+
+TEST(Trajectory, cubic)
+{
+  // 匀加速运动 x = t^2, 三次插值应明显优于线性插值
+  Trajectory<std::chrono::milliseconds> traj;
+  for (int i = 0; i <= 10; ++i)
+    traj.Append(i * 1000, {i * i * 1.0, i * 2.0, 0});
+
+  Eigen::Vector3d lin, cub;
+  traj.Position(4500, lin, Interp::Linear);
+  traj.Position(4500, cub, Interp::Cubic);
+  EXPECT_NEAR(lin.x(), 20.5, 1e-9);
+  EXPECT_NEAR(cub.x(), 20.25, 1e-9);
+  EXPECT_NEAR(cub.y(), 9.0, 1e-9);
+  // 节点处与原始值一致
+  traj.Position(7000, cub, Interp::Cubic);
+  EXPECT_NEAR(cub.x(), 49.0, 1e-9);
+}
+
+TEST(Trajectory, attitude)
+{
+  Trajectory<> traj;
+  Eigen::Quaterniond q0(Eigen::AngleAxisd(0, Eigen::Vector3d::UnitZ()));
+  Eigen::Quaterniond q1(Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ()));
+  traj.Append(0, {0, 0, 0}, q0);
+  traj.Append(1000000, {1, 0, 0}, q1);
+
+  Eigen::Quaterniond q;
+  EXPECT_TRUE(traj.Attitude(250000, q));
+  Eigen::Quaterniond q_true(Eigen::AngleAxisd(M_PI / 8, Eigen::Vector3d::UnitZ()));
+  EXPECT_NEAR(q.angularDistance(q_true), 0, 1e-12);
+}
+
+TEST(Trajectory, batch)
+{
+  Trajectory<> traj;
+  for (int i = 0; i < 100; ++i)
+    traj.Append(i * 100000, {std::sin(i * 0.1), std::cos(i * 0.1), i * 0.5});
+
+  std::vector<int64_t> t;
+  for (int64_t k = -50000; k < 10000000; k += 33333)
+    t.push_back(k);
+
+  std::vector<double> xyz(t.size() * 3);
+  size_t n = traj.Positions(t.data(), t.size(), xyz.data(), Interp::Cubic);
+  EXPECT_GT(n, 0u);
+  EXPECT_LT(n, t.size());
+
+  size_t valid = 0;
+  for (size_t k = 0; k < t.size(); ++k)
+  {
+    Eigen::Vector3d pos;
+    if (traj.Position(t[k], pos, Interp::Cubic))
+    {
+      ++valid;
+      EXPECT_DOUBLE_EQ(pos.x(), xyz[3 * k]);
+      EXPECT_DOUBLE_EQ(pos.y(), xyz[3 * k + 1]);
+      EXPECT_DOUBLE_EQ(pos.z(), xyz[3 * k + 2]);
+    }
+    else
+      EXPECT_TRUE(std::isnan(xyz[3 * k]));
+  }
+  EXPECT_EQ(valid, n);
+}
+
+TEST(Trajectory, batch_unordered)
+{
+  // 多路传感器合并后的时间戳常有少量乱序, 回退的查询不能沿当前区间外推
+  Trajectory<> traj;
+  for (int i = 0; i < 10; ++i)
+    traj.Append(i * 100000, {i * i * 1.0, 0, 0}, Eigen::Quaterniond(Eigen::AngleAxisd(i * i * 0.01, Eigen::Vector3d::UnitZ())));
+
+  std::vector<int64_t> t = {750000, 120000, 860000, 850000, 50000, 900000};
+  std::vector<double> xyz(t.size() * 3);
+  std::vector<Eigen::Quaterniond> q(t.size());
+  EXPECT_EQ(traj.Positions(t.data(), t.size(), xyz.data(), Interp::Cubic), t.size());
+  EXPECT_EQ(traj.Attitudes(t.data(), t.size(), q.data()), t.size());
+  for (size_t k = 0; k < t.size(); ++k)
+  {
+    Eigen::Vector3d pos;
+    Eigen::Quaterniond att;
+    EXPECT_TRUE(traj.Position(t[k], pos, Interp::Cubic));
+    EXPECT_TRUE(traj.Attitude(t[k], att));
+    EXPECT_DOUBLE_EQ(pos.x(), xyz[3 * k]) << t[k];
+    EXPECT_NEAR(q[k].angularDistance(att), 0, 1e-12) << t[k];
+  }
+}
+
+TEST(Trajectory, gpst)
+{
+  Trajectory<> traj;
+  traj.Append(time_system::gpst_t(2000, 100.0), {0, 0, 0});
+  traj.Append(time_system::gpst_t(2000, 101.0), {1, 0, 0});
+
+  Eigen::Vector3d pos;
+  EXPECT_TRUE(traj.Position(time_system::gpst_t(2000, 100.25), pos));
+  EXPECT_NEAR(pos.x(), 0.25, 1e-9);
+}
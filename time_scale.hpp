@@ -0,0 +1,209 @@
+#pragma once
+#include "time_system.hpp"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace time_system
+{
+  /**
+   * 各时间尺度的时刻均表示为该尺度下自1970-01-01 00:00:00起的连续计数(精度_Dura),
+   * UTC即为unix时间, GPST计数减去inner::delta_gpst0即为GPSTime::Count().
+   * 每个尺度给出其基准尺度(TAI或UTC)及 Offset() = 基准 - 本尺度 (秒).
+   */
+  namespace scale
+  {
+    struct TAI
+    {
+      using base = TAI;
+      static constexpr int64_t Offset() { return 0; }
+    };
+    struct GPST
+    {
+      using base = TAI;
+      static constexpr int64_t Offset() { return 19; }
+    };
+    struct GST // Galileo时与GPST对齐
+    {
+      using base = TAI;
+      static constexpr int64_t Offset() { return 19; }
+    };
+    struct BDT // 北斗时, 2006-01-01起, 比GPST慢14秒
+    {
+      using base = TAI;
+      static constexpr int64_t Offset() { return 33; }
+    };
+    struct UTC
+    {
+      using base = UTC;
+      static constexpr int64_t Offset() { return 0; }
+    };
+    struct GLONASST // UTC(SU) + 3h
+    {
+      using base = UTC;
+      static constexpr int64_t Offset() { return -3 * 3600; }
+    };
+  }
+
+  namespace inner
+  {
+    template <typename _Dura>
+    constexpr int64_t ScaleSeconds(const int64_t s_)
+    {
+      return sc::duration_cast<_Dura>(sc::seconds(s_)).count();
+    }
+
+    template <typename _Dura>
+    constexpr int64_t ToSeconds(const int64_t t_)
+    {
+      return sc::duration_cast<sc::seconds>(_Dura(t_)).count();
+    }
+
+    // 缓存闰秒表中的当前区间, 相邻时刻通常落在同一区间内, 查询只需两次比较.
+    // 闰秒表中的时刻起即采用新的闰秒数, 区间为 [lo, hi)
+    struct LeapCache
+    {
+      // 返回 UTC - GPST (秒), sec_为UTC秒
+      int32_t Get(const int64_t sec_) { return Lookup(sec_, false, utc_range_); }
+
+      // 返回 UTC - GPST (秒), sec_为GPST秒; 插入的闰秒本身映射到其后的UTC整秒
+      int32_t GetFromGPST(const int64_t sec_) { return Lookup(sec_, true, gps_range_); }
+
+    private:
+      struct Interval
+      {
+        int64_t lo = 0;
+        int64_t hi = 0;
+        int32_t leap = 0;
+      };
+
+      // 表项的起始时刻, gps_为true时换算到GPST
+      static int64_t Start(const size_t i, const bool gps_)
+      {
+        return __leaps[i].first - (gps_ ? __leaps[i].second : 0);
+      }
+
+      static int32_t Lookup(const int64_t sec_, const bool gps_, Interval &range)
+      {
+        if (sec_ >= range.lo && sec_ < range.hi)
+          return range.leap;
+        size_t const n = sizeof(__leaps) / sizeof(__leaps[0]);
+        size_t i = 0;
+        while (i < n && sec_ < Start(i, gps_))
+          ++i;
+        range.lo = i < n ? Start(i, gps_) : std::numeric_limits<int64_t>::min();
+        range.hi = i > 0 ? Start(i - 1, gps_) : std::numeric_limits<int64_t>::max();
+        range.leap = i < n ? __leaps[i].second : 0;
+        return range.leap;
+      }
+
+      Interval utc_range_;
+      Interval gps_range_;
+    };
+
+    // 基准尺度间的转换, 仅TAI与UTC之间需要查闰秒表
+    template <typename _From, typename _To, typename _Dura>
+    struct BaseConverter;
+
+    template <typename _Base, typename _Dura>
+    struct BaseConverter<_Base, _Base, _Dura>
+    {
+      static int64_t Convert(const int64_t t_, LeapCache &) { return t_; }
+    };
+
+    // TAI - UTC = 19 - (UTC - GPST)
+    template <typename _Dura>
+    struct BaseConverter<scale::UTC, scale::TAI, _Dura>
+    {
+      static int64_t Convert(const int64_t t_, LeapCache &cache)
+      {
+        return t_ + ScaleSeconds<_Dura>(19 - cache.Get(ToSeconds<_Dura>(t_)));
+      }
+    };
+
+    template <typename _Dura>
+    struct BaseConverter<scale::TAI, scale::UTC, _Dura>
+    {
+      static int64_t Convert(const int64_t t_, LeapCache &cache)
+      {
+        int32_t const leap = cache.GetFromGPST(ToSeconds<_Dura>(t_) - 19);
+        return t_ + ScaleSeconds<_Dura>(leap - 19);
+      }
+    };
+  }
+
+  /**
+   * @brief 时间尺度转换, 尺度对在编译期确定
+   *
+   * 同一基准的尺度之间为常数偏移, Convert编译为一次加法; 跨TAI/UTC时经闰秒表转换.
+   */
+  template <typename _From, typename _To, typename _Dura = sc::microseconds,
+            bool = std::is_same<typename _From::base, typename _To::base>::value>
+  struct ScaleConverter
+  {
+    static constexpr bool kConstant = true;
+    static constexpr int64_t Offset() { return inner::ScaleSeconds<_Dura>(_From::Offset() - _To::Offset()); }
+
+    static constexpr int64_t Convert(const int64_t t_) { return t_ + Offset(); }
+
+    static void Convert(int64_t const *in_, int64_t *out_, const size_t n_)
+    {
+      int64_t const offset = Offset();
+      for (size_t i = 0; i < n_; ++i)
+        out_[i] = in_[i] + offset;
+    }
+  };
+
+  template <typename _From, typename _To, typename _Dura>
+  struct ScaleConverter<_From, _To, _Dura, false>
+  {
+    static constexpr bool kConstant = false;
+    using _Base = inner::BaseConverter<typename _From::base, typename _To::base, _Dura>;
+
+    static int64_t Convert(const int64_t t_, inner::LeapCache &cache)
+    {
+      int64_t const from_base = inner::ScaleSeconds<_Dura>(_From::Offset());
+      int64_t const to_base = inner::ScaleSeconds<_Dura>(_To::Offset());
+      return _Base::Convert(t_ + from_base, cache) - to_base;
+    }
+
+    static int64_t Convert(const int64_t t_)
+    {
+      inner::LeapCache cache;
+      return Convert(t_, cache);
+    }
+
+    // 批量转换, 闰秒区间在相邻历元间复用
+    static void Convert(int64_t const *in_, int64_t *out_, const size_t n_)
+    {
+      inner::LeapCache cache;
+      for (size_t i = 0; i < n_; ++i)
+        out_[i] = Convert(in_[i], cache);
+    }
+  };
+
+  template <typename _From, typename _To, typename _Dura = sc::microseconds>
+  constexpr int64_t ConvertScale(const int64_t t_)
+  {
+    return ScaleConverter<_From, _To, _Dura>::Convert(t_);
+  }
+
+  template <typename _From, typename _To, typename _Dura = sc::microseconds>
+  inline void ConvertScale(int64_t const *in_, int64_t *out_, const size_t n_)
+  {
+    ScaleConverter<_From, _To, _Dura>::Convert(in_, out_, n_);
+  }
+
+  // 任意尺度的时刻转为GPS周+周内计数
+  template <typename _From, typename _Dura = sc::microseconds>
+  inline GPSTime<_Dura> Scale2GPSTime(const int64_t t_)
+  {
+    return GPSTime<_Dura>(0, ConvertScale<_From, scale::GPST, _Dura>(t_) - sc::duration_cast<_Dura>(inner::delta_gpst0).count());
+  }
+
+  template <typename _To, typename _Dura = sc::microseconds>
+  inline int64_t GPSTime2Scale(const GPSTime<_Dura> &t_)
+  {
+    return ConvertScale<scale::GPST, _To, _Dura>(t_.Count() + sc::duration_cast<_Dura>(inner::delta_gpst0).count());
+  }
+}
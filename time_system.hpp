@@ -43,7 +43,7 @@ namespace time_system
     }
   }
 
-  inline double CurrentUnixTime() { return sc::system_clock::now().time_since_epoch().count() / 1e9; }
+  inline double CurrentUnixTime() { return sc::duration_cast<_d_second>(sc::system_clock::now().time_since_epoch()).count(); }
   template <typename _Dura = sc::microseconds>
   constexpr typename _Dura::rep GPST2Unix(const int32_t w_, const double s_)
   {
@@ -144,6 +144,135 @@ namespace time_system
     return oss.str();
   }
 
+  /**
+   * @brief 周+周内整数计数的GPS时间, 运算、比较及与unix时间的转换均为整数且constexpr
+   *
+   * @tparam _Dura 周内计数的精度, 需不粗于秒
+   */
+  template <typename _Dura = sc::microseconds>
+  class GPSTime
+  {
+    static_assert(_Dura::period::num == 1, "GPSTime duration must be seconds or finer");
+
+  public:
+    using rep = int64_t;
+
+    constexpr GPSTime() = default;
+    constexpr GPSTime(const int32_t w_, const rep n_) : week_(w_), ticks_(n_) { Normalize(); }
+    constexpr GPSTime(const int32_t w_, const _Dura d_) : GPSTime(w_, static_cast<rep>(d_.count())) {}
+
+    // 由gpst_t构造, 周内秒四舍五入到_Dura
+    static GPSTime FromPair(const gpst_t &t_)
+    {
+      return GPSTime(t_.first, static_cast<rep>(std::llround(t_.second * _Dura::period::den)));
+    }
+
+    static constexpr GPSTime FromUnix(const int64_t t_)
+    {
+      return GPSTime(0, t_ - Offset());
+    }
+
+    static constexpr rep WeekTicks() { return sc::duration_cast<_Dura>(_week(1)).count(); }
+    static constexpr rep TicksPerSecond() { return _Dura::period::den; }
+
+    constexpr int32_t Week() const { return week_; }
+    constexpr rep Ticks() const { return ticks_; }                       // 周内计数
+    constexpr rep Count() const { return week_ * WeekTicks() + ticks_; } // 自gps起点的计数
+    constexpr _Dura SinceEpoch() const { return _Dura(Count()); }
+    constexpr int64_t ToUnix() const { return Count() + Offset(); }
+
+    // 与旧接口兼容, 周内秒为double
+    constexpr double Seconds() const { return static_cast<double>(ticks_) / TicksPerSecond(); }
+    constexpr gpst_t ToPair() const { return gpst_t(week_, Seconds()); }
+
+    constexpr GPSTime &operator+=(const _Dura d_)
+    {
+      ticks_ += d_.count();
+      Normalize();
+      return *this;
+    }
+    constexpr GPSTime &operator-=(const _Dura d_) { return *this += -d_; }
+    friend constexpr GPSTime operator+(GPSTime t_, const _Dura d_) { return t_ += d_; }
+    friend constexpr GPSTime operator-(GPSTime t_, const _Dura d_) { return t_ -= d_; }
+    friend constexpr _Dura operator-(const GPSTime &a_, const GPSTime &b_)
+    {
+      return _Dura((a_.week_ - b_.week_) * WeekTicks() + (a_.ticks_ - b_.ticks_));
+    }
+
+    friend constexpr bool operator==(const GPSTime &a_, const GPSTime &b_) { return a_.week_ == b_.week_ && a_.ticks_ == b_.ticks_; }
+    friend constexpr bool operator!=(const GPSTime &a_, const GPSTime &b_) { return !(a_ == b_); }
+    friend constexpr bool operator<(const GPSTime &a_, const GPSTime &b_)
+    {
+      return a_.week_ < b_.week_ || (a_.week_ == b_.week_ && a_.ticks_ < b_.ticks_);
+    }
+    friend constexpr bool operator>(const GPSTime &a_, const GPSTime &b_) { return b_ < a_; }
+    friend constexpr bool operator<=(const GPSTime &a_, const GPSTime &b_) { return !(b_ < a_); }
+    friend constexpr bool operator>=(const GPSTime &a_, const GPSTime &b_) { return !(a_ < b_); }
+
+    // 与GPST2Str格式一致, 仅用整数运算
+    std::string ToStr(bool show_week_ = false) const
+    {
+      std::ostringstream oss;
+      if (show_week_)
+        oss << std::setw(6) << week_;
+      std::ostringstream sec;
+      sec << ticks_ / TicksPerSecond();
+      if (Digits() > 0)
+        sec << '.' << std::setw(Digits()) << std::setfill('0') << ticks_ % TicksPerSecond();
+      oss << std::setw(16) << sec.str();
+      return oss.str();
+    }
+
+  private:
+    // unix计数与gps计数之差
+    static constexpr rep Offset()
+    {
+      return sc::duration_cast<_Dura>(inner::delta_gpst0 + sc::seconds(inner::Leaps())).count();
+    }
+
+    static constexpr int Digits()
+    {
+      int n = 0;
+      for (rep den = TicksPerSecond(); den > 1; den /= 10)
+        ++n;
+      return n;
+    }
+
+    constexpr void Normalize()
+    {
+      rep w = ticks_ / WeekTicks();
+      ticks_ %= WeekTicks();
+      if (ticks_ < 0)
+      {
+        ticks_ += WeekTicks();
+        --w;
+      }
+      week_ += static_cast<int32_t>(w);
+    }
+
+  private:
+    int32_t week_ = 0;
+    rep ticks_ = 0;
+  };
+
+  template <typename _Dura = sc::microseconds>
+  constexpr int64_t GPST2Unix(const GPSTime<_Dura> &gpst_)
+  {
+    return gpst_.ToUnix();
+  }
+
+  template <typename _Dura = sc::microseconds>
+  constexpr GPSTime<_Dura> Unix2GPSTime(const int64_t t_)
+  {
+    return GPSTime<_Dura>::FromUnix(t_);
+  }
+
+  template <typename _Dura = sc::microseconds>
+  inline std::string GPST2Str(const GPSTime<_Dura> &t_, bool show_week_ = false)
+  {
+    return t_.ToStr(show_week_);
+  }
+
   /**
    * @brief 输出unix时间,gps时间
    *
@@ -1,4 +1,6 @@
 #include "../coordinate_converter.hpp"
+#include "../nmea.hpp"
+#include <cstdio>
 #include <iostream>
 #include <iomanip>
 #include <string>
@@ -44,6 +46,10 @@ DEFINE_double(east, 0.0, "ENU东向坐标（米）");
 DEFINE_double(north, 0.0, "ENU北向坐标（米）");
 DEFINE_double(up, 0.0, "ENU上向坐标（米）");
 
+// NMEA输入的命令行参数
+DEFINE_string(input, "-", "NMEA文件路径，-表示标准输入");
+DEFINE_string(output, "llh", "NMEA输出格式: llh, ecef, enu");
+
 // 将LLH转换为ECEF
 void llh2ecef()
 {
@@ -109,6 +115,73 @@ void enu2llh()
     LOG(INFO) << "  高度: " << std::fixed << std::setprecision(6) << llh.z() << " 米";
 }
 
+// 解析NMEA GGA/RMC并逐行输出 unix时间(微秒) 与坐标
+int nmea()
+{
+    if (FLAGS_output != "llh" && FLAGS_output != "ecef" && FLAGS_output != "enu")
+    {
+        LOG(ERROR) << "错误: 未知输出格式 '" << FLAGS_output << "'";
+        return 1;
+    }
+    FILE *fp = FLAGS_input == "-" ? stdin : fopen(FLAGS_input.c_str(), "rb");
+    if (!fp)
+    {
+        LOG(ERROR) << "错误: 无法打开文件 '" << FLAGS_input << "'";
+        return 1;
+    }
+
+    // 未指定原点时以第一个含高程的定位点为ENU原点
+    bool has_origin = FLAGS_origin_lat != 0.0 || FLAGS_origin_lon != 0.0 || FLAGS_origin_height != 0.0;
+    WGS84 wgs84;
+    if (has_origin)
+        wgs84.SetOrigin({deg2rad(FLAGS_origin_lat), deg2rad(FLAGS_origin_lon), FLAGS_origin_height});
+
+    // 首条RMC之前的GGA没有日期, 时间无效, 跳过并计数
+    size_t undated = 0;
+    auto on_fix = [&](NmeaFix const &fix)
+    {
+        if (!fix.dated)
+        {
+            ++undated;
+            return;
+        }
+        if (FLAGS_output == "llh")
+        {
+            printf("%lld %.9f %.9f %.4f\n", static_cast<long long>(fix.t), rad2deg(fix.llh[0]), rad2deg(fix.llh[1]), fix.llh[2]);
+            return;
+        }
+        if (std::isnan(fix.llh[2]))
+            return;
+        Eigen::Vector3d const llh(fix.llh);
+        Eigen::Vector3d xyz;
+        if (FLAGS_output == "ecef")
+            xyz = WGS84::LLH2ECEF(llh);
+        else
+        {
+            if (!has_origin)
+            {
+                wgs84.SetOrigin(llh);
+                has_origin = true;
+            }
+            xyz = wgs84.LLH2ENU(llh);
+        }
+        printf("%lld %.4f %.4f %.4f\n", static_cast<long long>(fix.t), xyz.x(), xyz.y(), xyz.z());
+    };
+
+    NmeaParser<> parser;
+    std::vector<char> buffer(1 << 20);
+    size_t count = 0;
+    for (size_t n = 0; (n = fread(buffer.data(), 1, buffer.size(), fp)) > 0;)
+        count += parser.Feed(buffer.data(), n, on_fix);
+    count += parser.Flush(on_fix);
+    if (fp != stdin)
+        fclose(fp);
+
+    LOG(INFO) << "定位结果: " << count - undated << " 条, 无日期跳过: " << undated << " 条, 校验和错误: "
+              << parser.ChecksumErrors() << " 条";
+    return 0;
+}
+
 // 帮助信息
 void printHelp()
 {
@@ -120,6 +193,7 @@ void printHelp()
     LOG(INFO) << "  ecef2llh --x=<x> --y=<y> --z=<z>";
     LOG(INFO) << "  llh2enu --lat=<纬度> --lon=<经度> --height=<高度> --origin_lat=<原点纬度> --origin_lon=<原点经度> --origin_height=<原点高度>";
     LOG(INFO) << "  enu2llh --east=<东> --north=<北> --up=<上> --origin_lat=<原点纬度> --origin_lon=<原点经度> --origin_height=<原点高度>";
+    LOG(INFO) << "  nmea --input=<文件|-> --output=<llh|ecef|enu> [--origin_lat=<原点纬度> --origin_lon=<原点经度> --origin_height=<原点高度>]";
     LOG(INFO) << "  help";
     LOG(INFO) << "";
     LOG(INFO) << "注意:";
@@ -142,6 +216,7 @@ int main(int argc, char *argv[])
     ecef2llh --x=<x> --y=<y> --z=<z>
     llh2enu --lat=<纬度> --lon=<经度> --height=<高度> --origin_lat=<原点纬度> --origin_lon=<原点经度> --origin_height=<原点高度>
     enu2llh --east=<东> --north=<北> --up=<上> --origin_lat=<原点纬度> --origin_lon=<原点经度> --origin_height=<原点高度>
+    nmea --input=<文件|-> --output=<llh|ecef|enu> [--origin_lat=<原点纬度> --origin_lon=<原点经度> --origin_height=<原点高度>]
     help;
     注意:    角度单位为度，高度单位为米;    坐标顺序为: 纬度, 经度, 高度;
 )";
@@ -176,6 +251,12 @@ int main(int argc, char *argv[])
     {
         enu2llh();
     }
+    else if (command == "nmea")
+    {
+        int ret = nmea();
+        google::ShutdownGoogleLogging();
+        return ret;
+    }
     else
     {
         LOG(ERROR) << "错误: 未知命令 '" << command << "'";
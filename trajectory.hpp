@@ -0,0 +1,227 @@
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include "coordinate_converter.hpp"
+#include "time_system.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace coordinate_converter
+{
+  enum class Interp
+  {
+    Linear, // 分段线性
+    Cubic   // 三次Hermite(Catmull-Rom切线)
+  };
+
+  /**
+   * @brief 以unix时间为索引的轨迹, 位置与姿态按SoA存储
+   *
+   * 位置所在坐标系由调用者决定(ECEF或以WGS84::LLH2ENU得到的局部东北天), 插值在该坐标系内进行.
+   * 时间戳必须严格递增, 单次查询O(log n), 有序批量查询为线性归并.
+   *
+   * @tparam _Dura 时间戳精度, 与time_system中的模板参数一致
+   */
+  template <typename _Dura = time_system::sc::microseconds>
+  class Trajectory
+  {
+  public:
+    using rep = typename _Dura::rep;
+
+    void Reserve(const size_t n)
+    {
+      t_.reserve(n);
+      for (auto *v : {&x_, &y_, &z_, &qw_, &qx_, &qy_, &qz_})
+        v->reserve(n);
+    }
+
+    void Clear()
+    {
+      t_.clear();
+      for (auto *v : {&x_, &y_, &z_, &qw_, &qx_, &qy_, &qz_})
+        v->clear();
+    }
+
+    size_t Size() const { return t_.size(); }
+    bool Empty() const { return t_.empty(); }
+    rep Time(const size_t i) const { return t_[i]; }
+    rep StartTime() const { return t_.front(); }
+    rep EndTime() const { return t_.back(); }
+    Eigen::Vector3d Position(const size_t i) const { return {x_[i], y_[i], z_[i]}; }
+    Eigen::Quaterniond Attitude(const size_t i) const { return {qw_[i], qx_[i], qy_[i], qz_[i]}; }
+
+    // 追加一个历元, 时间不递增时返回false
+    bool Append(const rep t, Eigen::Vector3d const &pos, Eigen::Quaterniond const &q = Eigen::Quaterniond::Identity())
+    {
+      if (!t_.empty() && t <= t_.back())
+        return false;
+      t_.push_back(t);
+      x_.push_back(pos[0]);
+      y_.push_back(pos[1]);
+      z_.push_back(pos[2]);
+      Eigen::Quaterniond qn = q.normalized();
+      // 保证相邻四元数同半球, 使slerp走最短路径
+      if (qw_.size() > 0 && Attitude(qw_.size() - 1).dot(qn) < 0)
+        qn.coeffs() = -qn.coeffs();
+      qw_.push_back(qn.w());
+      qx_.push_back(qn.x());
+      qy_.push_back(qn.y());
+      qz_.push_back(qn.z());
+      return true;
+    }
+
+    bool Append(time_system::gpst_t const &t, Eigen::Vector3d const &pos, Eigen::Quaterniond const &q = Eigen::Quaterniond::Identity())
+    {
+      return Append(time_system::GPST2Unix<_Dura>(t), pos, q);
+    }
+
+    // 插值位置, t超出轨迹范围时返回false
+    bool Position(const rep t, double *xyz, const Interp method = Interp::Linear) const
+    {
+      size_t const i = Locate(t);
+      if (i == npos)
+        return false;
+      PositionAt(i, t, xyz, method);
+      return true;
+    }
+
+    bool Position(const rep t, Eigen::Vector3d &pos, const Interp method = Interp::Linear) const
+    {
+      return Position(t, pos.data(), method);
+    }
+
+    bool Position(time_system::gpst_t const &t, Eigen::Vector3d &pos, const Interp method = Interp::Linear) const
+    {
+      return Position(time_system::GPST2Unix<_Dura>(t), pos.data(), method);
+    }
+
+    // 姿态球面线性插值
+    bool Attitude(const rep t, Eigen::Quaterniond &q) const
+    {
+      size_t const i = Locate(t);
+      if (i == npos)
+        return false;
+      q = AttitudeAt(i, t);
+      return true;
+    }
+
+    bool Attitude(time_system::gpst_t const &t, Eigen::Quaterniond &q) const
+    {
+      return Attitude(time_system::GPST2Unix<_Dura>(t), q);
+    }
+
+    /**
+     * @brief 有序时间序列的批量位置插值, 按线性归并推进区间
+     *
+     * @param t 查询时间, 长度n; 非递减时为线性归并, 遇到回退的时刻重新二分查找区间
+     * @param xyz 输出, 长度3n, 超出轨迹范围的点填NaN
+     * @return size_t 成功插值的点数
+     */
+    size_t Positions(rep const *t, const size_t n, double *xyz, const Interp method = Interp::Linear) const
+    {
+      size_t count = 0;
+      size_t i = 0;
+      for (size_t k = 0; k < n; ++k)
+      {
+        double *out = xyz + 3 * k;
+        if (t_.size() < 2 || t[k] < t_.front() || t[k] > t_.back())
+        {
+          out[0] = out[1] = out[2] = std::numeric_limits<double>::quiet_NaN();
+          continue;
+        }
+        if (t[k] < t_[i])
+          i = Locate(t[k]);
+        while (i + 2 < t_.size() && t_[i + 1] <= t[k])
+          ++i;
+        PositionAt(i, t[k], out, method);
+        ++count;
+      }
+      return count;
+    }
+
+    // 有序时间序列的批量姿态插值, 超出范围的点填NaN, 时刻回退时重新查找区间
+    size_t Attitudes(rep const *t, const size_t n, Eigen::Quaterniond *q) const
+    {
+      size_t count = 0;
+      size_t i = 0;
+      for (size_t k = 0; k < n; ++k)
+      {
+        if (t_.size() < 2 || t[k] < t_.front() || t[k] > t_.back())
+        {
+          q[k].coeffs().setConstant(std::numeric_limits<double>::quiet_NaN());
+          continue;
+        }
+        if (t[k] < t_[i])
+          i = Locate(t[k]);
+        while (i + 2 < t_.size() && t_[i + 1] <= t[k])
+          ++i;
+        q[k] = AttitudeAt(i, t[k]);
+        ++count;
+      }
+      return count;
+    }
+
+  private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // 返回满足 t_[i] <= t <= t_[i+1] 的区间起点
+    size_t Locate(const rep t) const
+    {
+      if (t_.size() < 2 || t < t_.front() || t > t_.back())
+        return npos;
+      size_t const i = std::upper_bound(t_.begin(), t_.end(), t) - t_.begin();
+      return std::min(i, t_.size() - 1) - 1;
+    }
+
+    double Ratio(const size_t i, const rep t) const
+    {
+      return static_cast<double>(t - t_[i]) / static_cast<double>(t_[i + 1] - t_[i]);
+    }
+
+    // 第i点处的切线(单位: 米/时间刻度)
+    double Tangent(std::vector<double> const &v, const size_t i) const
+    {
+      size_t const i0 = i > 0 ? i - 1 : i;
+      size_t const i1 = i + 1 < t_.size() ? i + 1 : i;
+      return (v[i1] - v[i0]) / static_cast<double>(t_[i1] - t_[i0]);
+    }
+
+    void PositionAt(const size_t i, const rep t, double *xyz, const Interp method) const
+    {
+      double const u = Ratio(i, t);
+      std::vector<double> const *v[3] = {&x_, &y_, &z_};
+      if (method == Interp::Linear)
+      {
+        for (int k = 0; k < 3; ++k)
+          xyz[k] = (*v[k])[i] + u * ((*v[k])[i + 1] - (*v[k])[i]);
+        return;
+      }
+      double const dt = static_cast<double>(t_[i + 1] - t_[i]);
+      double const u2 = u * u;
+      double const u3 = u2 * u;
+      double const h00 = 2 * u3 - 3 * u2 + 1;
+      double const h10 = u3 - 2 * u2 + u;
+      double const h01 = -2 * u3 + 3 * u2;
+      double const h11 = u3 - u2;
+      for (int k = 0; k < 3; ++k)
+      {
+        std::vector<double> const &p = *v[k];
+        xyz[k] = h00 * p[i] + h10 * dt * Tangent(p, i) + h01 * p[i + 1] + h11 * dt * Tangent(p, i + 1);
+      }
+    }
+
+    Eigen::Quaterniond AttitudeAt(const size_t i, const rep t) const
+    {
+      return Attitude(i).slerp(Ratio(i, t), Attitude(i + 1));
+    }
+
+  private:
+    std::vector<rep> t_;
+    std::vector<double> x_, y_, z_;
+    std::vector<double> qw_, qx_, qy_, qz_;
+  };
+
+} // namespace coordinate_converter
+
+#endif // TRAJECTORY_HPP